@@ -0,0 +1,548 @@
+#include "FadeEventRecorder.h"
+#include "QFadingScrollArea.h"
+
+#include <QAbstractItemView>
+#include <QApplication>
+#include <QDebug>
+#include <QEventLoop>
+#include <QFile>
+#include <QItemSelectionModel>
+#include <QJsonDocument>
+#include <QKeyEvent>
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QScrollBar>
+#include <QTimer>
+#include <QWheelEvent>
+
+namespace {
+
+const int kFormatVersion = 2;
+
+// Ключ области в записи: objectName(), а если он пуст — порядковый номер
+QString areaKey(const QFadingScrollArea *area, int index)
+{
+    if (!area->objectName().isEmpty())
+        return area->objectName();
+    return QString("area%1").arg(index);
+}
+
+QAbstractItemView *itemViewOf(const QFadingScrollArea *area)
+{
+    return qobject_cast<QAbstractItemView*>(area->widget());
+}
+
+// Виджет, в который пришло событие: item view внутри области или сама область
+QString targetOf(const QFadingScrollArea *area, const QWidget *w)
+{
+    QAbstractItemView *view = itemViewOf(area);
+    if (view && (w == view || view->isAncestorOf(w)))
+        return QStringLiteral("view");
+    return QStringLiteral("area");
+}
+
+// Текущая ячейка view: от неё зависит, куда сдвинут список клавиши
+void recordCurrentCell(const QAbstractItemView *view, QJsonObject &entry)
+{
+    const QModelIndex current = view ? view->currentIndex() : QModelIndex();
+    if (!current.isValid())
+        return;
+    entry["row"] = current.row();
+    entry["column"] = current.column();
+}
+
+// Восстанавливает текущую ячейку без прокрутки к ней: позицию скролла
+// задают записанные значения скроллбаров
+void restoreCurrentCell(QAbstractItemView *view, const QJsonObject &entry)
+{
+    if (!view || !view->model() || !view->selectionModel() || !entry.contains("row"))
+        return;
+
+    const QModelIndex index = view->model()->index(entry["row"].toInt(),
+                                                   entry["column"].toInt(),
+                                                   view->rootIndex());
+    if (!index.isValid() || index == view->currentIndex())
+        return;
+
+    const bool autoScroll = view->hasAutoScroll();
+    view->setAutoScroll(false);
+    view->selectionModel()->setCurrentIndex(index, QItemSelectionModel::NoUpdate);
+    view->setAutoScroll(autoScroll);
+}
+
+// Область обычно лежит в layout, поэтому воспроизводим размер окна целиком
+void resizeWindowTo(QFadingScrollArea *area, const QSize &size)
+{
+    if (size.isValid() && area->window()->size() != size)
+        area->window()->resize(size);
+}
+
+} // namespace
+
+// Реализация FadePaintProfiler
+FadePaintProfiler::FadePaintProfiler(QObject *parent)
+    : QObject(parent)
+{
+}
+
+FadePaintProfiler::~FadePaintProfiler()
+{
+    stop();
+}
+
+void FadePaintProfiler::start()
+{
+    if (m_running)
+        return;
+
+    m_running = true;
+    qApp->installEventFilter(this);
+}
+
+void FadePaintProfiler::stop()
+{
+    if (!m_running)
+        return;
+
+    m_running = false;
+    qApp->removeEventFilter(this);
+}
+
+void FadePaintProfiler::reset()
+{
+    m_paintEvents = 0;
+    m_paintMs = 0.0;
+    m_repaintArea = 0;
+}
+
+bool FadePaintProfiler::eventFilter(QObject *obj, QEvent *event)
+{
+    if (event->type() != QEvent::Paint)
+        return QObject::eventFilter(obj, event);
+
+    ++m_paintEvents;
+    for (const QRect &r : static_cast<QPaintEvent*>(event)->region())
+        m_repaintArea += qint64(r.width()) * r.height();
+
+    // Доставляем событие сами, сняв фильтр на время доставки
+    qApp->removeEventFilter(this);
+    QElapsedTimer timer;
+    timer.start();
+    QApplication::sendEvent(obj, event);
+    m_paintMs += timer.nsecsElapsed() / 1e6;
+    qApp->installEventFilter(this);
+    return true;
+}
+
+// Реализация FadeEventRecorder
+FadeEventRecorder::FadeEventRecorder(QObject *parent)
+    : QObject(parent)
+{
+}
+
+FadeEventRecorder::~FadeEventRecorder()
+{
+    stop();
+}
+
+void FadeEventRecorder::addArea(QFadingScrollArea *area)
+{
+    if (!area || m_areas.contains(area))
+        return;
+
+    m_areas.append(area);
+
+    // Любое действие скроллбара (перетаскивание, стрелки, клик по жёлобу,
+    // колесо, PageUp/PageDown) пишем как итоговую позицию ползунка.
+    // При воспроизведении setValue() той же позиции после уже
+    // воспроизведённого колеса или клавиши ничего не делает.
+    QList<QMetaObject::Connection> &connections = m_connections[area];
+    auto watch = [this, area, &connections](QScrollBar *sb, const char *target) {
+        connections << connect(sb, &QScrollBar::actionTriggered,
+                               this, [this, area, sb, target](int action) {
+            QJsonObject entry;
+            entry["type"] = "slider";
+            entry["target"] = target;
+            entry["action"] = action;
+            entry["value"] = sb->sliderPosition();
+            record(area, entry);
+        });
+    };
+    watch(area->verticalScrollBar(), "area");
+    if (QAbstractItemView *view = itemViewOf(area))
+        watch(view->verticalScrollBar(), "view");
+
+    if (m_recording)
+        recordState(area);
+}
+
+void FadeEventRecorder::removeArea(QFadingScrollArea *area)
+{
+    for (const QMetaObject::Connection &c : m_connections.take(area))
+        disconnect(c);
+    m_areas.removeAll(area);
+}
+
+void FadeEventRecorder::start()
+{
+    if (m_recording)
+        return;
+
+    m_recording = true;
+    m_clock.start();
+    qApp->installEventFilter(this);
+
+    // Начальное состояние, чтобы воспроизведение стартовало с той же позиции
+    for (const QPointer<QFadingScrollArea> &area : m_areas) {
+        if (area)
+            recordState(area);
+    }
+}
+
+void FadeEventRecorder::stop()
+{
+    if (!m_recording)
+        return;
+
+    m_recording = false;
+    qApp->removeEventFilter(this);
+}
+
+void FadeEventRecorder::clear()
+{
+    m_events = QJsonArray();
+    m_lastEvent = nullptr;
+    m_lastReceiver = nullptr;
+    if (m_recording)
+        m_clock.restart();
+}
+
+QJsonObject FadeEventRecorder::toJson() const
+{
+    QJsonObject root;
+    root["version"] = kFormatVersion;
+    root["events"] = m_events;
+    return root;
+}
+
+bool FadeEventRecorder::save(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    const QByteArray data = QJsonDocument(toJson()).toJson(QJsonDocument::Compact);
+    return file.write(data) == data.size();
+}
+
+QFadingScrollArea *FadeEventRecorder::areaFor(QObject *obj) const
+{
+    QWidget *w = qobject_cast<QWidget*>(obj);
+    if (!w)
+        return nullptr;
+
+    for (const QPointer<QFadingScrollArea> &area : m_areas) {
+        if (area && (area == w || area->isAncestorOf(w)))
+            return area;
+    }
+    return nullptr;
+}
+
+QString FadeEventRecorder::keyFor(QFadingScrollArea *area) const
+{
+    return areaKey(area, m_areas.indexOf(area));
+}
+
+void FadeEventRecorder::record(QFadingScrollArea *area, QJsonObject entry)
+{
+    if (!m_recording)
+        return;
+
+    entry["t"] = m_clock.elapsed();
+    entry["area"] = keyFor(area);
+    m_events.append(entry);
+}
+
+void FadeEventRecorder::recordState(QFadingScrollArea *area)
+{
+    QJsonObject entry;
+    entry["type"] = "state";
+    entry["winW"] = area->window()->width();
+    entry["winH"] = area->window()->height();
+    // Размер самой области — только для проверки при воспроизведении
+    entry["w"] = area->width();
+    entry["h"] = area->height();
+    entry["areaValue"] = area->verticalScrollBar()->value();
+    if (QAbstractItemView *view = itemViewOf(area)) {
+        entry["viewValue"] = view->verticalScrollBar()->value();
+        recordCurrentCell(view, entry);
+    }
+    record(area, entry);
+}
+
+bool FadeEventRecorder::eventFilter(QObject *obj, QEvent *event)
+{
+    switch (event->type()) {
+    case QEvent::Wheel:
+    case QEvent::KeyPress:
+    case QEvent::KeyRelease: {
+        QFadingScrollArea *area = areaFor(obj);
+        if (!area)
+            break;
+
+        // Непринятые события колеса и клавиш всплывают к родителям тем же
+        // объектом. Пропускаем только такое всплытие: адрес, тип и время
+        // совпадают, а получатель — предок предыдущего. Автоповтор клавиш
+        // (KeyRelease + KeyPress с одним временем) и события с нулевым
+        // временем так не теряются.
+        QWidget *w = static_cast<QWidget*>(obj);
+        const quint64 timestamp = static_cast<QInputEvent*>(event)->timestamp();
+        QWidget *lastReceiver = qobject_cast<QWidget*>(m_lastReceiver.data());
+        if (event == m_lastEvent && event->type() == m_lastType
+                && timestamp == m_lastTimestamp
+                && lastReceiver && w->isAncestorOf(lastReceiver))
+            break;
+        m_lastEvent = event;
+        m_lastType = event->type();
+        m_lastTimestamp = timestamp;
+        m_lastReceiver = obj;
+
+        const QString target = targetOf(area, w);
+        QJsonObject entry;
+        entry["target"] = target;
+
+        if (event->type() == QEvent::Wheel) {
+            auto *we = static_cast<QWheelEvent*>(event);
+            QAbstractItemView *view = itemViewOf(area);
+            QWidget *vp = (target == "view" && view) ? view->viewport() : area->viewport();
+            const QPointF pos = vp->mapFromGlobal(we->globalPosition());
+            entry["type"] = "wheel";
+            entry["x"] = pos.x();
+            entry["y"] = pos.y();
+            entry["dx"] = we->angleDelta().x();
+            entry["dy"] = we->angleDelta().y();
+            entry["px"] = we->pixelDelta().x();
+            entry["py"] = we->pixelDelta().y();
+            entry["buttons"] = int(we->buttons());
+            entry["mods"] = int(we->modifiers());
+            entry["phase"] = int(we->phase());
+            entry["inverted"] = we->inverted();
+        } else {
+            auto *ke = static_cast<QKeyEvent*>(event);
+            entry["type"] = "key";
+            entry["press"] = event->type() == QEvent::KeyPress;
+            entry["key"] = ke->key();
+            entry["mods"] = int(ke->modifiers());
+            entry["text"] = ke->text();
+            entry["repeat"] = ke->isAutoRepeat();
+            entry["count"] = ke->count();
+            // Клавиши двигают текущую ячейку, а клики мышью не пишутся,
+            // поэтому запоминаем её перед каждой клавишей
+            recordCurrentCell(itemViewOf(area), entry);
+        }
+        record(area, entry);
+        break;
+    }
+    case QEvent::Resize: {
+        // Пишем размер окна, в котором лежат области, один раз на окно
+        QWidget *w = qobject_cast<QWidget*>(obj);
+        if (!w || !w->isWindow())
+            break;
+
+        QFadingScrollArea *area = nullptr;
+        for (const QPointer<QFadingScrollArea> &a : m_areas) {
+            if (a && a->window() == w) {
+                area = a;
+                break;
+            }
+        }
+        if (!area)
+            break;
+
+        const QSize size = static_cast<QResizeEvent*>(event)->size();
+        QJsonObject entry;
+        entry["type"] = "resize";
+        entry["w"] = size.width();
+        entry["h"] = size.height();
+        record(area, entry);
+        break;
+    }
+    default:
+        break;
+    }
+    return QObject::eventFilter(obj, event);
+}
+
+// Реализация FadeEventReplayer
+FadeEventReplayer::FadeEventReplayer(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void FadeEventReplayer::addArea(QFadingScrollArea *area)
+{
+    if (area && !m_areas.contains(area))
+        m_areas.append(area);
+}
+
+bool FadeEventReplayer::load(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (!doc.isObject())
+        return false;
+
+    const QJsonObject root = doc.object();
+    if (root["version"].toInt() != kFormatVersion)
+        return false;
+
+    m_events = root["events"].toArray();
+    return true;
+}
+
+QFadingScrollArea *FadeEventReplayer::areaFor(const QString &key) const
+{
+    for (int i = 0; i < m_areas.size(); ++i) {
+        if (m_areas[i] && areaKey(m_areas[i], i) == key)
+            return m_areas[i];
+    }
+    return nullptr;
+}
+
+int FadeEventReplayer::totalDeferredUpdates() const
+{
+    int total = 0;
+    for (const QPointer<QFadingScrollArea> &area : m_areas) {
+        if (area)
+            total += area->deferredUpdateCount();
+    }
+    return total;
+}
+
+void FadeEventReplayer::wait(qint64 ms)
+{
+    if (ms <= 0) {
+        QApplication::processEvents();
+        return;
+    }
+
+    QEventLoop loop;
+    QTimer::singleShot(int(ms), &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+QList<FadeEventReplayer::Frame> FadeEventReplayer::run(bool realTime)
+{
+    m_frames.clear();
+
+    // Даём отработать отложенной инициализации overlay/делегата
+    wait(50);
+
+    m_profiler.reset();
+    m_profiler.start();
+
+    QElapsedTimer clock;
+    clock.start();
+    int deferredBefore = totalDeferredUpdates();
+
+    for (const QJsonValue &value : m_events) {
+        const QJsonObject entry = value.toObject();
+        QFadingScrollArea *area = areaFor(entry["area"].toString());
+        if (!area)
+            continue;
+
+        // Пауза до следующего события относится к предыдущему кадру
+        const qint64 t = qint64(entry["t"].toDouble());
+        if (realTime)
+            wait(t - clock.elapsed());
+
+        const int deferredNow = totalDeferredUpdates();
+        if (!m_frames.isEmpty())
+            m_frames.last().deferredUpdates = deferredNow - deferredBefore;
+        deferredBefore = deferredNow;
+        takePaintStats();
+
+        Frame frame;
+        frame.time = t;
+        frame.type = entry["type"].toString();
+        m_frames.append(frame);
+
+        dispatch(area, entry);
+        QApplication::processEvents();
+    }
+
+    // Досчитываем отложенные обновления последнего кадра
+    wait(50);
+    if (!m_frames.isEmpty())
+        m_frames.last().deferredUpdates = totalDeferredUpdates() - deferredBefore;
+    takePaintStats();
+
+    m_profiler.stop();
+    return m_frames;
+}
+
+void FadeEventReplayer::takePaintStats()
+{
+    // Всё, что отрисовано до начала следующего кадра, относится к текущему
+    if (!m_frames.isEmpty()) {
+        Frame &frame = m_frames.last();
+        frame.paintEvents += m_profiler.paintEvents();
+        frame.paintMs += m_profiler.paintMs();
+        frame.repaintArea += m_profiler.repaintArea();
+    }
+    m_profiler.reset();
+}
+
+void FadeEventReplayer::dispatch(QFadingScrollArea *area, const QJsonObject &entry)
+{
+    const QString type = entry["type"].toString();
+    QAbstractItemView *view = itemViewOf(area);
+    const bool toView = entry["target"].toString() == "view" && view;
+
+    if (type == "state") {
+        resizeWindowTo(area, QSize(entry["winW"].toInt(), entry["winH"].toInt()));
+        QApplication::processEvents();
+
+        const QSize recorded(entry["w"].toInt(), entry["h"].toInt());
+        if (area->size() != recorded) {
+            qWarning().noquote() << QString("%1: размер %2x%3 вместо записанного %4x%5")
+                                    .arg(entry["area"].toString())
+                                    .arg(area->width()).arg(area->height())
+                                    .arg(recorded.width()).arg(recorded.height());
+        }
+        area->verticalScrollBar()->setValue(entry["areaValue"].toInt());
+        restoreCurrentCell(view, entry);
+        if (view && entry.contains("viewValue"))
+            view->verticalScrollBar()->setValue(entry["viewValue"].toInt());
+    } else if (type == "resize") {
+        resizeWindowTo(area, QSize(entry["w"].toInt(), entry["h"].toInt()));
+    } else if (type == "slider") {
+        QScrollBar *sb = toView ? view->verticalScrollBar() : area->verticalScrollBar();
+        sb->setValue(entry["value"].toInt());
+    } else if (type == "wheel") {
+        QWidget *vp = toView ? view->viewport() : area->viewport();
+        const QPointF pos(entry["x"].toDouble(), entry["y"].toDouble());
+        QWheelEvent we(pos, vp->mapToGlobal(pos),
+                       QPoint(entry["px"].toInt(), entry["py"].toInt()),
+                       QPoint(entry["dx"].toInt(), entry["dy"].toInt()),
+                       Qt::MouseButtons(entry["buttons"].toInt()),
+                       Qt::KeyboardModifiers(entry["mods"].toInt()),
+                       Qt::ScrollPhase(entry["phase"].toInt()),
+                       entry["inverted"].toBool());
+        QApplication::sendEvent(vp, &we);
+    } else if (type == "key") {
+        QWidget *target = toView ? static_cast<QWidget*>(view) : area;
+        if (toView)
+            restoreCurrentCell(view, entry);
+        QKeyEvent ke(entry["press"].toBool() ? QEvent::KeyPress : QEvent::KeyRelease,
+                     entry["key"].toInt(),
+                     Qt::KeyboardModifiers(entry["mods"].toInt()),
+                     entry["text"].toString(),
+                     entry["repeat"].toBool(),
+                     quint16(entry["count"].toInt(1)));
+        QApplication::sendEvent(target, &ke);
+    }
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+class QFadingScrollArea;
+
+// Замеряет отрисовку во всём приложении: число paint-событий, их суммарное
+// время и площадь перерисованных регионов. Используется бенчмарком и
+// воспроизведением записей.
+class FadePaintProfiler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit FadePaintProfiler(QObject *parent = nullptr);
+    ~FadePaintProfiler() override;
+
+    // Фильтр событий на приложении ставится только на время замера
+    void start();
+    void stop();
+    bool isRunning() const { return m_running; }
+
+    void reset();
+
+    int    paintEvents() const { return m_paintEvents; }
+    double paintMs() const     { return m_paintMs; }
+    qint64 repaintArea() const { return m_repaintArea; }   // px
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *event) override;
+
+private:
+    int    m_paintEvents = 0;
+    double m_paintMs     = 0.0;
+    qint64 m_repaintArea = 0;
+    bool   m_running     = false;
+};
+
+// Записывает входящие события QFadingScrollArea (колесо, клавиши, действия
+// скроллбара, resize окна) с отметками времени в компактный JSON.
+// Подключается через QFadingScrollArea::setEventRecorder(); один рекордер
+// может писать сразу несколько областей, они различаются по objectName().
+class FadeEventRecorder : public QObject
+{
+    Q_OBJECT
+public:
+    explicit FadeEventRecorder(QObject *parent = nullptr);
+    ~FadeEventRecorder() override;
+
+    // Вызываются из QFadingScrollArea::setEventRecorder()
+    void addArea(QFadingScrollArea *area);
+    void removeArea(QFadingScrollArea *area);
+
+    // Фильтр событий на приложении ставится только на время записи
+    void start();
+    void stop();
+    bool isRecording() const { return m_recording; }
+
+    void clear();
+    int  eventCount() const { return m_events.size(); }
+
+    QJsonObject toJson() const;
+    bool save(const QString &fileName) const;
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *event) override;
+
+private:
+    QFadingScrollArea *areaFor(QObject *obj) const;
+    QString keyFor(QFadingScrollArea *area) const;
+    void record(QFadingScrollArea *area, QJsonObject entry);
+    void recordState(QFadingScrollArea *area);
+
+    QList<QPointer<QFadingScrollArea>> m_areas;
+    QHash<QFadingScrollArea*, QList<QMetaObject::Connection>> m_connections;
+    QJsonArray m_events;
+    QElapsedTimer m_clock;
+    bool m_recording = false;
+
+    // Событие, которое всплывает к родителям, пишем только один раз
+    const QEvent *m_lastEvent = nullptr;
+    QEvent::Type m_lastType = QEvent::None;
+    quint64 m_lastTimestamp = 0;
+    QPointer<QObject> m_lastReceiver;
+};
+
+// Воспроизводит запись FadeEventRecorder на тех же областях (по objectName())
+// и собирает статистику по кадрам: время отрисовки, площадь перерисовки и
+// число отложенных обновлений overlay. Кадр — одно входное событие и всё,
+// что было отрисовано до следующего.
+class FadeEventReplayer : public QObject
+{
+    Q_OBJECT
+public:
+    struct Frame {
+        qint64  time            = 0;    // мс от начала записи
+        QString type;
+        int     paintEvents     = 0;
+        double  paintMs         = 0.0;
+        qint64  repaintArea     = 0;    // px
+        int     deferredUpdates = 0;
+    };
+
+    explicit FadeEventReplayer(QObject *parent = nullptr);
+
+    void addArea(QFadingScrollArea *area);
+
+    bool load(const QString &fileName);
+    int  eventCount() const { return m_events.size(); }
+
+    // realTime: выдерживать паузы между событиями, как при записи,
+    // чтобы отложенные обновления срабатывали так же, как у пользователя
+    QList<Frame> run(bool realTime = true);
+
+private:
+    QFadingScrollArea *areaFor(const QString &key) const;
+    void dispatch(QFadingScrollArea *area, const QJsonObject &entry);
+    int  totalDeferredUpdates() const;
+    void wait(qint64 ms);
+    void takePaintStats();
+
+    QList<QPointer<QFadingScrollArea>> m_areas;
+    QJsonArray m_events;
+    QList<Frame> m_frames;
+    FadePaintProfiler m_profiler;
+};
@@ -1,4 +1,5 @@
 #include "QFadingScrollArea.h"
+#include "FadeEventRecorder.h"
 
 #include <QScrollBar>
 #include <QPainter>
@@ -6,9 +7,11 @@
 #include <QShowEvent>
 #include <QResizeEvent>
 #include <QPaintEvent>
+#include <QChildEvent>
 #include <QApplication>
 #include <QPalette>
 #include <QListView>
+#include <QAbstractItemView>
 #include <QAbstractItemModel>
 #include <QModelIndex>
 #include <algorithm>
@@ -51,6 +54,135 @@ void FadeOverlay::paintEvent(QPaintEvent *event)
     }
 }
 
+// Реализация FadeItemDelegate
+FadeItemDelegate::FadeItemDelegate(QFadingScrollArea *area,
+                                   QAbstractItemDelegate *source,
+                                   QObject *parent)
+    : QStyledItemDelegate(parent)
+    , m_area(area)
+    , m_source(source)
+{
+    // View подписан на сигналы своего делегата, т.е. обёртки,
+    // поэтому пробрасываем сигналы редакторов исходного делегата
+    if (m_source) {
+        connect(m_source, &QAbstractItemDelegate::commitData,
+                this, &QAbstractItemDelegate::commitData);
+        connect(m_source, &QAbstractItemDelegate::closeEditor,
+                this, &QAbstractItemDelegate::closeEditor);
+        connect(m_source, &QAbstractItemDelegate::sizeHintChanged,
+                this, &QAbstractItemDelegate::sizeHintChanged);
+    }
+}
+
+void FadeItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
+                             const QModelIndex &index) const
+{
+    const qreal opacity = m_area ? m_area->itemFadeOpacity(option.rect) : 1.0;
+
+    // Строки вне полос фейда рисуются без save()/restore()
+    if (opacity >= 1.0) {
+        if (m_source)
+            m_source->paint(painter, option, index);
+        else
+            QStyledItemDelegate::paint(painter, option, index);
+        return;
+    }
+
+    if (opacity <= 0.0)
+        return;
+
+    painter->save();
+    painter->setOpacity(painter->opacity() * opacity);
+    if (m_source)
+        m_source->paint(painter, option, index);
+    else
+        QStyledItemDelegate::paint(painter, option, index);
+    painter->restore();
+}
+
+QSize FadeItemDelegate::sizeHint(const QStyleOptionViewItem &option,
+                                 const QModelIndex &index) const
+{
+    if (m_source)
+        return m_source->sizeHint(option, index);
+    return QStyledItemDelegate::sizeHint(option, index);
+}
+
+QWidget *FadeItemDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+                                        const QModelIndex &index) const
+{
+    if (!m_source)
+        return QStyledItemDelegate::createEditor(parent, option, index);
+
+    // View ставит фильтром редактора обёртку; ставим и исходный делегат,
+    // чтобы работал его собственный eventFilter() (см. eventFilter() ниже)
+    QWidget *editor = m_source->createEditor(parent, option, index);
+    if (editor)
+        editor->installEventFilter(m_source);
+    return editor;
+}
+
+void FadeItemDelegate::destroyEditor(QWidget *editor, const QModelIndex &index) const
+{
+    if (m_source)
+        m_source->destroyEditor(editor, index);
+    else
+        QStyledItemDelegate::destroyEditor(editor, index);
+}
+
+void FadeItemDelegate::setEditorData(QWidget *editor, const QModelIndex &index) const
+{
+    if (m_source)
+        m_source->setEditorData(editor, index);
+    else
+        QStyledItemDelegate::setEditorData(editor, index);
+}
+
+void FadeItemDelegate::setModelData(QWidget *editor, QAbstractItemModel *model,
+                                    const QModelIndex &index) const
+{
+    if (m_source)
+        m_source->setModelData(editor, model, index);
+    else
+        QStyledItemDelegate::setModelData(editor, model, index);
+}
+
+void FadeItemDelegate::updateEditorGeometry(QWidget *editor, const QStyleOptionViewItem &option,
+                                            const QModelIndex &index) const
+{
+    if (m_source)
+        m_source->updateEditorGeometry(editor, option, index);
+    else
+        QStyledItemDelegate::updateEditorGeometry(editor, option, index);
+}
+
+bool FadeItemDelegate::helpEvent(QHelpEvent *event, QAbstractItemView *view,
+                                 const QStyleOptionViewItem &option,
+                                 const QModelIndex &index)
+{
+    if (m_source)
+        return m_source->helpEvent(event, view, option, index);
+    return QStyledItemDelegate::helpEvent(event, view, option, index);
+}
+
+bool FadeItemDelegate::eventFilter(QObject *obj, QEvent *event)
+{
+    // Клавиши и потерю фокуса редактора обрабатывает фильтр исходного делегата,
+    // его commitData/closeEditor пробрасываются через обёртку
+    if (m_source)
+        return false;
+    return QStyledItemDelegate::eventFilter(obj, event);
+}
+
+bool FadeItemDelegate::editorEvent(QEvent *event, QAbstractItemModel *model,
+                                   const QStyleOptionViewItem &option,
+                                   const QModelIndex &index)
+{
+    if (m_source)
+        return m_source->editorEvent(event, model, option, index);
+    return QStyledItemDelegate::editorEvent(event, model, option, index);
+}
+
 QFadingScrollArea::QFadingScrollArea(QWidget *parent)
     : QScrollArea(parent)
 {
@@ -68,22 +200,8 @@ QFadingScrollArea::QFadingScrollArea(QWidget *parent)
             this, [this](int){
         startScrollEffect();
         // Принудительно обновляем overlay через таймер (несколько раз для надёжности)
-        QTimer::singleShot(0, this, [this]() {
-            if (m_overlay) {
-                m_overlay->raise();
-                m_overlay->update();
-            }
-            // Также обновляем сам QScrollArea для отрисовки градиентов в paintEvent
-            update();
-        });
-        QTimer::singleShot(10, this, [this]() {
-            if (m_overlay) {
-                m_overlay->raise();
-                m_overlay->update();
-            }
-            // Также обновляем сам QScrollArea для отрисовки градиентов в paintEvent
-            update();
-        });
+        deferOverlayUpdate(0, true);
+        deferOverlayUpdate(10, true);
     });
 
     // Более плавный скролл
@@ -109,22 +227,8 @@ QFadingScrollArea::QFadingScrollArea(QWidget *widget, QWidget *parent)
             this, [this](int){
         startScrollEffect();
         // Принудительно обновляем overlay через таймер (несколько раз для надёжности)
-        QTimer::singleShot(0, this, [this]() {
-            if (m_overlay) {
-                m_overlay->raise();
-                m_overlay->update();
-            }
-            // Также обновляем сам QScrollArea для отрисовки градиентов в paintEvent
-            update();
-        });
-        QTimer::singleShot(10, this, [this]() {
-            if (m_overlay) {
-                m_overlay->raise();
-                m_overlay->update();
-            }
-            // Также обновляем сам QScrollArea для отрисовки градиентов в paintEvent
-            update();
-        });
+        deferOverlayUpdate(0, true);
+        deferOverlayUpdate(10, true);
     });
 
     // Более плавный скролл
@@ -149,18 +253,19 @@ void QFadingScrollArea::resizeEvent(QResizeEvent *event)
     QScrollArea::resizeEvent(event);
     updateOverlayGeometry();
     // Также обновляем overlay при изменении размера
-    QTimer::singleShot(0, this, [this]() {
-        if (m_overlay) {
-            m_overlay->raise();
-            m_overlay->update();
-        }
-    });
+    deferOverlayUpdate(0, false);
 }
 
 void QFadingScrollArea::setupOverlay()
 {
     if (!viewport())
         return;
+
+    // В режиме делегата overlay и фильтры событий не нужны
+    if (usesDelegateFade()) {
+        setupDelegate();
+        return;
+    }
         
     if (!m_overlay) {
         // Для ListView создаём overlay как дочерний виджет самого QScrollArea
@@ -204,18 +309,32 @@ void QFadingScrollArea::updateOverlayGeometry()
         }
         m_overlay->raise(); // Поднимаем overlay поверх всех дочерних виджетов
         // Принудительно обновляем overlay
-        QTimer::singleShot(0, this, [this]() {
-            if (m_overlay) {
-                m_overlay->raise();
-                if (isListView()) {
-                    m_overlay->stackUnder(nullptr);
-                }
-                m_overlay->update();
-            }
-        });
+        deferOverlayUpdate(0, false);
     }
 }
 
+void QFadingScrollArea::deferOverlayUpdate(int delayMs, bool updateArea)
+{
+    // Без overlay (режим делегата или до showEvent) отложенное обновление
+    // не планируется и не считается, но сам QScrollArea перерисовываем
+    if (!m_overlay) {
+        if (updateArea)
+            update();
+        return;
+    }
+
+    ++m_deferredUpdates;
+    QTimer::singleShot(delayMs, this, [this, updateArea]() {
+        if (m_overlay) {
+            m_overlay->raise();
+            m_overlay->update();
+        }
+        // Также обновляем сам QScrollArea для отрисовки градиентов в paintEvent
+        if (updateArea)
+            update();
+    });
+}
+
 void QFadingScrollArea::setFadeHeight(int h)
 {
     h = std::max(0, h);
@@ -225,6 +344,8 @@ void QFadingScrollArea::setFadeHeight(int h)
     m_fadeHeight = h;
     if (m_overlay)
         m_overlay->update();
+    if (m_delegate && m_delegateView)
+        m_delegateView->viewport()->update();
 }
 
 void QFadingScrollArea::setFadeEnabled(bool on)
@@ -242,6 +363,24 @@ void QFadingScrollArea::setFadeEnabled(bool on)
         m_overlay->setVisible(m_fadeEnabled);
         m_overlay->update();
     }
+    if (m_delegate && m_delegateView)
+        m_delegateView->viewport()->update();
+}
+
+void QFadingScrollArea::setFadeMode(FadeMode mode)
+{
+    if (m_fadeMode == mode)
+        return;
+
+    m_fadeMode = mode;
+
+    // Снимаем текущую реализацию фейда и пересоздаём её в новом режиме
+    removeDelegate();
+    removeOverlay();
+    if (isVisible()) {
+        setupOverlay();
+        updateOverlayGeometry();
+    }
 }
 
 void QFadingScrollArea::setFadeTimeout(int ms)
@@ -253,6 +392,18 @@ void QFadingScrollArea::setFadeTimeout(int ms)
     m_scrollTimer.setInterval(m_fadeTimeout);
 }
 
+void QFadingScrollArea::setEventRecorder(FadeEventRecorder *recorder)
+{
+    if (m_recorder == recorder)
+        return;
+
+    if (m_recorder)
+        m_recorder->removeArea(this);
+    m_recorder = recorder;
+    if (m_recorder)
+        m_recorder->addArea(this);
+}
+
 bool QFadingScrollArea::isScrollable() const
 {
     const QScrollBar *sb = verticalScrollBar();
@@ -288,6 +439,163 @@ bool QFadingScrollArea::isListView() const
     return qobject_cast<QListView*>(w) != nullptr;
 }
 
+QAbstractItemView *QFadingScrollArea::itemView() const
+{
+    return qobject_cast<QAbstractItemView*>(widget());
+}
+
+bool QFadingScrollArea::usesDelegateFade() const
+{
+    return m_fadeMode == DelegateFade && itemView() != nullptr;
+}
+
+void QFadingScrollArea::setupDelegate()
+{
+    QAbstractItemView *view = itemView();
+    if (!view || m_delegate)
+        return;
+
+    // Делегат принадлежит view и удаляется вместе с ним
+    m_delegate = new FadeItemDelegate(this, view->itemDelegate(), view);
+    m_delegateView = view;
+    view->setItemDelegate(m_delegate);
+
+    // При скролле view сдвигает уже нарисованные пиксели, поэтому
+    // строки, въехавшие в полосы фейда или выехавшие из них, нужно перерисовать
+    m_itemScrollValue = view->verticalScrollBar()->value();
+    updateBandAnchor();
+    m_itemScrollConnection = connect(view->verticalScrollBar(), &QScrollBar::valueChanged,
+                                     this, &QFadingScrollArea::updateFadeBands);
+    view->viewport()->update();
+
+    // Следим за заменой widget(), чтобы снять делегат с ушедшего view
+    viewport()->installEventFilter(this);
+}
+
+void QFadingScrollArea::removeDelegate()
+{
+    disconnect(m_itemScrollConnection);
+    if (!m_delegate)
+        return;
+
+    QAbstractItemView *view = m_delegateView;
+    m_delegateView = nullptr;
+    m_bandAnchor = QModelIndex();
+    if (view && view->itemDelegate() == m_delegate) {
+        view->setItemDelegate(m_delegate->sourceDelegate());
+        view->viewport()->update();
+    }
+    m_delegate->deleteLater();
+    m_delegate = nullptr;
+}
+
+void QFadingScrollArea::removeOverlay()
+{
+    if (!m_overlay)
+        return;
+
+    viewport()->removeEventFilter(this);
+    if (widget())
+        widget()->removeEventFilter(this);
+    delete m_overlay;
+    m_overlay = nullptr;
+}
+
+void QFadingScrollArea::updateFadeBands(int value)
+{
+    const int delta = value - m_itemScrollValue;
+    m_itemScrollValue = value;
+
+    QAbstractItemView *view = m_delegateView;
+    if (!m_delegate || !view || !m_fadeEnabled)
+        return;
+
+    QWidget *vp = view->viewport();
+
+    // Насколько viewport()->scroll() сдвинул уже нарисованные пиксели.
+    // При скролле по строкам value считается в строках, поэтому сдвиг
+    // в пикселях берём по смещению запомненной строки.
+    int shift = -delta;
+    if (view->verticalScrollMode() != QAbstractItemView::ScrollPerPixel) {
+        const QRect anchorRect = m_bandAnchor.isValid() ? view->visualRect(m_bandAnchor) : QRect();
+        if (!anchorRect.isValid()) {
+            updateBandAnchor();
+            vp->update();
+            return;
+        }
+        shift = anchorRect.top() - m_bandAnchorTop;
+    }
+    updateBandAnchor();
+
+    const int w = vp->width();
+    const int h = vp->height();
+    const int fade = std::min(m_fadeHeight, h / 2);
+    if (w <= 0 || fade <= 0)
+        return;
+
+    // Прозрачность считается на всю строку, поэтому захватываем
+    // и строки, лишь частично попавшие в полосу
+    QRect topBand(0, 0, w, fade);
+    const QModelIndex topIndex = view->indexAt(QPoint(0, fade - 1));
+    if (topIndex.isValid())
+        topBand |= view->visualRect(topIndex);
+
+    QRect bottomBand(0, h - fade, w, fade);
+    const QModelIndex bottomIndex = view->indexAt(QPoint(0, h - fade));
+    if (bottomIndex.isValid())
+        bottomBand |= view->visualRect(bottomIndex);
+
+    // Строки, нарисованные полупрозрачными в полосах, теперь лежат
+    // на shift пикселей ниже (или выше)
+    const QRect vpRect = vp->rect();
+    vp->update(topBand);
+    vp->update(bottomBand);
+    if (shift != 0) {
+        vp->update(topBand.translated(0, shift) & vpRect);
+        vp->update(bottomBand.translated(0, shift) & vpRect);
+    }
+}
+
+void QFadingScrollArea::updateBandAnchor()
+{
+    QAbstractItemView *view = m_delegateView;
+    m_bandAnchor = view ? view->indexAt(QPoint(0, 0)) : QModelIndex();
+    m_bandAnchorTop = m_bandAnchor.isValid() ? view->visualRect(m_bandAnchor).top() : 0;
+}
+
+qreal QFadingScrollArea::itemFadeOpacity(const QRect &rect) const
+{
+    if (!m_fadeEnabled)
+        return 1.0;
+
+    QAbstractItemView *view = m_delegateView;
+    if (!view)
+        return 1.0;
+
+    const int h = view->viewport()->height();
+    const int fade = std::min(m_fadeHeight, h / 2);
+    if (fade <= 0)
+        return 1.0;
+
+    // Строка целиком вне полос — ничего не делаем
+    if (rect.top() >= fade && rect.bottom() < h - fade)
+        return 1.0;
+
+    const QScrollBar *sb = view->verticalScrollBar();
+    const qreal center = rect.top() + rect.height() / 2.0;
+    qreal opacity = 1.0;
+
+    // Верхняя полоса: только если не в самом верху
+    if (sb->value() > sb->minimum() && center < fade)
+        opacity = std::min(opacity, std::max(0.0, center / fade));
+
+    // Нижняя полоса: только если не в самом низу
+    if (sb->value() < sb->maximum() && center > h - fade)
+        opacity = std::min(opacity, std::max(0.0, (h - center) / fade));
+
+    return opacity;
+}
+
 bool QFadingScrollArea::shouldShowTopFade() const
 {
     if (!isScrollable())
@@ -344,34 +652,33 @@ void QFadingScrollArea::startScrollEffect()
     m_scrolling = true;
     m_scrollTimer.start();
     // Принудительно обновляем overlay при скролле
-    QTimer::singleShot(0, this, [this]() {
-        if (m_overlay) {
-            m_overlay->raise();
-            m_overlay->update();
-        }
-        // Также обновляем сам QScrollArea для отрисовки градиентов в paintEvent
-        update();
-    });
+    deferOverlayUpdate(0, true);
 }
 
 void QFadingScrollArea::onScrollTimeout()
 {
     m_scrolling = false;
     // Принудительно обновляем overlay после окончания скролла
-    QTimer::singleShot(0, this, [this]() {
-        if (m_overlay) {
-            m_overlay->raise();
-            m_overlay->update();
-        }
-        // Также обновляем сам QScrollArea для отрисовки градиентов в paintEvent
-        update();
-    });
+    deferOverlayUpdate(0, true);
 }
 
 bool QFadingScrollArea::eventFilter(QObject *obj, QEvent *event)
 {
+    // Смена widget(): снимаем делегат со старого view и ставим на новый
+    if (obj == viewport() && m_fadeMode == DelegateFade
+            && (event->type() == QEvent::ChildAdded || event->type() == QEvent::ChildRemoved)) {
+        QObject *child = static_cast<QChildEvent*>(event)->child();
+        if (event->type() == QEvent::ChildRemoved && m_delegate && child == m_delegateView)
+            removeDelegate();
+        else if (event->type() == QEvent::ChildAdded && !m_delegate && isVisible())
+            QTimer::singleShot(0, this, [this]() {
+                setupOverlay();
+                updateOverlayGeometry();
+            });
+    }
+
     // Обновляем overlay при каждом paintEvent viewport'а
-    if (obj == viewport()) {
+    if (obj == viewport() && m_overlay) {
         if (event->type() == QEvent::Paint) {
             // Даём viewport отрисоваться
             viewport()->removeEventFilter(this);
@@ -379,24 +686,8 @@ bool QFadingScrollArea::eventFilter(QObject *obj, QEvent *event)
             viewport()->installEventFilter(this);
             
             // Обновляем overlay после отрисовки viewport (несколько раз для надёжности)
-            QTimer::singleShot(0, this, [this]() {
-                if (m_overlay) {
-                    m_overlay->raise();
-                    m_overlay->stackUnder(nullptr);
-                    m_overlay->update();
-                }
-                // Также обновляем QScrollArea для отрисовки градиентов в paintEvent
-                update();
-            });
-            QTimer::singleShot(5, this, [this]() {
-                if (m_overlay) {
-                    m_overlay->raise();
-                    m_overlay->stackUnder(nullptr);
-                    m_overlay->update();
-                }
-                // Также обновляем QScrollArea для отрисовки градиентов в paintEvent
-                update();
-            });
+            deferOverlayUpdate(0, true);
+            deferOverlayUpdate(5, true);
             return true;
         } else if (event->type() == QEvent::Resize) {
             // Обновляем геометрию overlay при изменении размера viewport
@@ -406,24 +697,8 @@ bool QFadingScrollArea::eventFilter(QObject *obj, QEvent *event)
     // Также обновляем overlay при paintEvent самого widget'а (для ListView)
     else if (obj == widget() && event->type() == QEvent::Paint) {
         // Для ListView принудительно обновляем overlay после каждого paintEvent widget'а
-        QTimer::singleShot(0, this, [this]() {
-            if (m_overlay) {
-                m_overlay->raise();
-                m_overlay->stackUnder(nullptr);
-                m_overlay->update();
-            }
-            // Принудительно обновляем QScrollArea для отрисовки градиентов в paintEvent
-            update();
-        });
-        QTimer::singleShot(5, this, [this]() {
-            if (m_overlay) {
-                m_overlay->raise();
-                m_overlay->stackUnder(nullptr);
-                m_overlay->update();
-            }
-            // Принудительно обновляем QScrollArea для отрисовки градиентов в paintEvent
-            update();
-        });
+        deferOverlayUpdate(0, true);
+        deferOverlayUpdate(5, true);
     }
     return QScrollArea::eventFilter(obj, event);
 }
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <QPersistentModelIndex>
+#include <QPointer>
 #include <QScrollArea>
+#include <QStyledItemDelegate>
 #include <QTimer>
 #include <QWidget>
 
+class QAbstractItemView;
+class QFadingScrollArea;
+class FadeEventRecorder;
+
 class FadeOverlay : public QWidget
 {
     Q_OBJECT
@@ -16,6 +23,47 @@ protected:
     friend class QFadingScrollArea;
 };
 
+// Делегат-обёртка: применяет фейд прямо при отрисовке строк item view,
+// масштабируя прозрачность строки по её положению в полосе fadeHeight().
+// Строки вне полос рисуются исходным делегатом без изменений.
+class FadeItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+public:
+    explicit FadeItemDelegate(QFadingScrollArea *area,
+                              QAbstractItemDelegate *source,
+                              QObject *parent = nullptr);
+
+    QAbstractItemDelegate *sourceDelegate() const { return m_source; }
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option,
+               const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option,
+                   const QModelIndex &index) const override;
+
+    QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+                          const QModelIndex &index) const override;
+    void destroyEditor(QWidget *editor, const QModelIndex &index) const override;
+    void setEditorData(QWidget *editor, const QModelIndex &index) const override;
+    void setModelData(QWidget *editor, QAbstractItemModel *model,
+                      const QModelIndex &index) const override;
+    void updateEditorGeometry(QWidget *editor, const QStyleOptionViewItem &option,
+                              const QModelIndex &index) const override;
+    bool helpEvent(QHelpEvent *event, QAbstractItemView *view,
+                   const QStyleOptionViewItem &option,
+                   const QModelIndex &index) override;
+
+protected:
+    bool eventFilter(QObject *obj, QEvent *event) override;
+    bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                     const QStyleOptionViewItem &option,
+                     const QModelIndex &index) override;
+
+private:
+    QPointer<QFadingScrollArea> m_area;
+    QPointer<QAbstractItemDelegate> m_source;
+};
+
 class QFadingScrollArea : public QScrollArea
 {
     Q_OBJECT
@@ -23,6 +71,20 @@ public:
     explicit QFadingScrollArea(QWidget *parent = nullptr);
     explicit QFadingScrollArea(QWidget *widget, QWidget *parent);
 
+    // Способ отрисовки фейда:
+    // OverlayFade  — градиент рисуется поверх содержимого отдельным виджетом;
+    // DelegateFade — для item view прозрачность строк меняется в делегате,
+    //                без overlay и без дополнительного прохода отрисовки.
+    //                Для обычных виджетов используется OverlayFade.
+    enum FadeMode {
+        OverlayFade,
+        DelegateFade
+    };
+    Q_ENUM(FadeMode)
+
+    void setFadeMode(FadeMode mode);
+    FadeMode fadeMode() const { return m_fadeMode; }
+
     // Высота градиента сверху/снизу в пикселях
     void setFadeHeight(int h);
     int  fadeHeight() const { return m_fadeHeight; }
@@ -35,9 +97,17 @@ public:
     void setFadeTimeout(int ms);
     int  fadeTimeout() const { return m_fadeTimeout; }
     
+    // Запись входящих событий (колесо, клавиши, скроллбар, resize) для
+    // последующего воспроизведения. По умолчанию выключена (nullptr).
+    void setEventRecorder(FadeEventRecorder *recorder);
+    FadeEventRecorder *eventRecorder() const { return m_recorder; }
+
     // Публичные методы для проверки состояния (для отладки)
     bool isScrollable() const;
 
+    // Сколько отложенных обновлений overlay было запланировано
+    int deferredUpdateCount() const { return m_deferredUpdates; }
+
 protected:
     void showEvent(QShowEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
@@ -48,21 +118,43 @@ private slots:
     void onScrollTimeout();
 
     friend class FadeOverlay;
+    friend class FadeItemDelegate;
 
 private:
     void setupOverlay();
     void updateOverlayGeometry();
+    void deferOverlayUpdate(int delayMs, bool updateArea);
     void startScrollEffect();
     bool shouldShowTopFade() const;
     bool shouldShowBottomFade() const;
     void paintFadeOverlay(QPainter *painter);
     bool isListView() const;
+
+    QAbstractItemView *itemView() const;
+    bool usesDelegateFade() const;
+    void setupDelegate();
+    void removeDelegate();
+    void removeOverlay();
+    void updateFadeBands(int value);
+    void updateBandAnchor();
+    qreal itemFadeOpacity(const QRect &rect) const;
     
     FadeOverlay *m_overlay = nullptr;
+    QPointer<FadeItemDelegate> m_delegate;
+    QPointer<QAbstractItemView> m_delegateView;
+    int    m_itemScrollValue = 0;
+    // Верхняя видимая строка и её позиция: по ним считается сдвиг
+    // пикселей при скролле по строкам
+    QPersistentModelIndex m_bandAnchor;
+    int    m_bandAnchorTop = 0;
+    QMetaObject::Connection m_itemScrollConnection;
+    QPointer<FadeEventRecorder> m_recorder;
 
     QTimer m_scrollTimer;
     bool   m_scrolling   = false;
     bool   m_fadeEnabled = true;
     int    m_fadeHeight  = 24;   // px, сверху и снизу
     int    m_fadeTimeout = 250;  // мс
+    FadeMode m_fadeMode  = OverlayFade;
+    int    m_deferredUpdates = 0;
 };
@@ -6,10 +6,12 @@ TARGET = QFadingScrollAreaExample
 TEMPLATE = app
 
 SOURCES += \
+    FadeEventRecorder.cpp \
     QFadingScrollArea.cpp \
     main.cpp
 
 HEADERS += \
+    FadeEventRecorder.h \
     QFadingScrollArea.h
 
 # Установка кодировки для Windows (MinGW)
@@ -1,4 +1,5 @@
 #include "QFadingScrollArea.h"
+#include "FadeEventRecorder.h"
 
 #include <QApplication>
 #include <QMainWindow>
@@ -11,6 +12,11 @@
 #include <QStringListModel>
 #include <QGroupBox>
 #include <QScrollArea>
+#include <QScrollBar>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QDebug>
+#include <algorithm>
 
 // Пример 1: Использование с QWidget и QVBoxLayout
 QWidget* createWidgetExample(QWidget *parent)
@@ -33,6 +39,7 @@ QWidget* createWidgetExample(QWidget *parent)
     }
 
     auto *scroll = new QFadingScrollArea(parent);
+    scroll->setObjectName("widgetExample");
     scroll->setWidget(content);
 
     // Настройка параметров фейда
@@ -79,6 +86,7 @@ QWidget* createListViewExample(QWidget *parent)
     // Создаём QFadingScrollArea с QListView
     // Используем конструктор с двумя параметрами: widget и parent
     auto *scroll = new QFadingScrollArea(listView, parent);
+    scroll->setObjectName("listViewExample");
     
     // Настройка параметров фейда
     scroll->setFadeHeight(60);
@@ -88,10 +96,134 @@ QWidget* createListViewExample(QWidget *parent)
     return scroll;
 }
 
+// Прокручивает список на 100k строк в заданном режиме фейда шагами по
+// rowsPerStep строк из середины списка: view сдвигает уже нарисованные
+// пиксели и перерисовывает только открывшуюся часть
+static void benchmarkFadeMode(QFadingScrollArea::FadeMode mode, const char *name,
+                              QAbstractItemView::ScrollMode scrollMode, int rowsPerStep)
+{
+    const int rowCount = 100000;
+    const int steps = 1000;
+
+    QStringList items;
+    items.reserve(rowCount);
+    for (int i = 0; i < rowCount; ++i)
+        items << QString("Элемент списка %1").arg(i + 1);
+
+    auto *listView = new QListView;
+    listView->setModel(new QStringListModel(items, listView));
+    listView->setVerticalScrollMode(scrollMode);
+    listView->setUniformItemSizes(true);
+
+    QFadingScrollArea scroll(listView, nullptr);
+    scroll.setFadeMode(mode);
+    scroll.setFadeHeight(60);
+    scroll.resize(400, 600);
+    scroll.show();
+
+    // Даём отработать отложенной инициализации overlay/делегата
+    QEventLoop loop;
+    QTimer::singleShot(50, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    QScrollBar *sb = listView->verticalScrollBar();
+    const int stride = std::max(1, sb->singleStep()) * rowsPerStep;
+    const int first = sb->maximum() / 2;
+    sb->setValue(first);
+    QTimer::singleShot(20, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    FadePaintProfiler profiler;
+    profiler.start();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 1; i <= steps; ++i) {
+        sb->setValue(first + i * stride);
+        QApplication::processEvents();
+    }
+
+    // Дожидаемся отложенных обновлений (таймеры на 5-10 мс)
+    QTimer::singleShot(20, &loop, &QEventLoop::quit);
+    loop.exec();
+    const qint64 totalMs = timer.elapsed();
+
+    profiler.stop();
+
+    qInfo().noquote() << QString("%1, %2, %3 стр./шаг: %4 шагов, %5 мс всего, "
+                                 "отрисовка %6 мс (%7 мс/шаг), paint-событий: %8, перерисовано: %9 px")
+                         .arg(name)
+                         .arg(scrollMode == QAbstractItemView::ScrollPerPixel
+                              ? QString("ScrollPerPixel") : QString("ScrollPerItem"))
+                         .arg(rowsPerStep)
+                         .arg(steps)
+                         .arg(totalMs)
+                         .arg(profiler.paintMs(), 0, 'f', 3)
+                         .arg(profiler.paintMs() / steps, 0, 'f', 3)
+                         .arg(profiler.paintEvents())
+                         .arg(profiler.repaintArea());
+}
+
+static int runFadeBenchmark()
+{
+    // Шаг стрелки скроллбара и типичный шаг колеса (3 строки)
+    // ScrollPerItem — режим QAbstractItemView по умолчанию
+    for (auto scrollMode : {QAbstractItemView::ScrollPerPixel, QAbstractItemView::ScrollPerItem}) {
+        for (int rowsPerStep : {1, 3}) {
+            benchmarkFadeMode(QFadingScrollArea::OverlayFade, "OverlayFade", scrollMode, rowsPerStep);
+            benchmarkFadeMode(QFadingScrollArea::DelegateFade, "DelegateFade", scrollMode, rowsPerStep);
+        }
+    }
+    return 0;
+}
+
+// Печатает статистику воспроизведения по кадрам и итог
+static void printReplayReport(const QList<FadeEventReplayer::Frame> &frames)
+{
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+    qint64 totalArea = 0;
+    int totalPaints = 0;
+    int totalDeferred = 0;
+
+    qInfo().noquote() << "t_ms\ttype\tpaints\tpaint_ms\trepaint_px\tdeferred";
+    for (const FadeEventReplayer::Frame &f : frames) {
+        qInfo().noquote() << QString("%1\t%2\t%3\t%4\t%5\t%6")
+                             .arg(f.time)
+                             .arg(f.type)
+                             .arg(f.paintEvents)
+                             .arg(f.paintMs, 0, 'f', 3)
+                             .arg(f.repaintArea)
+                             .arg(f.deferredUpdates);
+        totalMs += f.paintMs;
+        maxMs = std::max(maxMs, f.paintMs);
+        totalArea += f.repaintArea;
+        totalPaints += f.paintEvents;
+        totalDeferred += f.deferredUpdates;
+    }
+
+    const int count = std::max(1, int(frames.size()));
+    qInfo().noquote() << QString("Кадров: %1, paint-событий: %2, отрисовка: %3 мс "
+                                 "(среднее %4 мс, максимум %5 мс), перерисовано: %6 px, "
+                                 "отложенных обновлений: %7")
+                         .arg(frames.size())
+                         .arg(totalPaints)
+                         .arg(totalMs, 0, 'f', 3)
+                         .arg(totalMs / count, 0, 'f', 3)
+                         .arg(maxMs, 0, 'f', 3)
+                         .arg(totalArea)
+                         .arg(totalDeferred);
+}
+
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
 
+    // Сравнение режимов фейда на модели из 100k строк:
+    //   QT_QPA_PLATFORM=offscreen ./QFadingScrollAreaExample --benchmark
+    if (app.arguments().contains("--benchmark"))
+        return runFadeBenchmark();
+
     QMainWindow window;
     window.setWindowTitle("QFadingScrollArea - Примеры использования");
     window.resize(800, 600);
@@ -123,6 +255,41 @@ int main(int argc, char *argv[])
     window.setCentralWidget(centralWidget);
     window.show();
 
+    auto *leftArea = qobject_cast<QFadingScrollArea*>(leftScroll);
+    auto *rightArea = qobject_cast<QFadingScrollArea*>(rightScroll);
+    const QStringList args = app.arguments();
+
+    // Воспроизведение записи без участия пользователя:
+    //   QT_QPA_PLATFORM=offscreen ./QFadingScrollAreaExample --replay session.json
+    const int replayIndex = args.indexOf("--replay");
+    if (replayIndex >= 0 && replayIndex + 1 < args.size()) {
+        FadeEventReplayer replayer;
+        replayer.addArea(leftArea);
+        replayer.addArea(rightArea);
+        if (!replayer.load(args.at(replayIndex + 1))) {
+            qWarning().noquote() << "Не удалось загрузить запись" << args.at(replayIndex + 1);
+            return 1;
+        }
+        printReplayReport(replayer.run());
+        return 0;
+    }
+
+    // Запись пользовательской сессии, сохраняется при выходе:
+    //   ./QFadingScrollAreaExample --record session.json
+    FadeEventRecorder recorder;
+    const int recordIndex = args.indexOf("--record");
+    if (recordIndex >= 0 && recordIndex + 1 < args.size()) {
+        const QString fileName = args.at(recordIndex + 1);
+        leftArea->setEventRecorder(&recorder);
+        rightArea->setEventRecorder(&recorder);
+        recorder.start();
+        QObject::connect(&app, &QCoreApplication::aboutToQuit, &recorder, [&recorder, fileName]() {
+            recorder.stop();
+            if (!recorder.save(fileName))
+                qWarning().noquote() << "Не удалось сохранить запись" << fileName;
+        });
+    }
+
     return app.exec();
 }
 